@@ -49,6 +49,23 @@ public:
         return standard->usersPerChannel() * standard->antennas();
     }
 
+    int antennasPerChannel() const { return standard->antennas(); }
+
+    // TDMA slots per frame; users on different antennas share a slot
+    int slotsPerFrame() const { return standard->usersPerChannel(); }
+
+    // air time of one message of msgBits bits (speed is Mb/s x10 == bits/us x10)
+    long long slotTimeUs(long long msgBits) const {
+        long long s10 = standard->speedMbpsTimes10();
+        if (s10 <= 0) return 0;
+        return (msgBits * 10LL + s10 - 1) / s10;
+    }
+
+    int channelOfUser(int index) const {
+        int perChan = usersPerChanCapacity();
+        return (perChan > 0) ? index / perChan : 0;
+    }
+
     int totalSupportedUsers() const {
         long long ch = numChannels();
         long long perChan = usersPerChanCapacity();
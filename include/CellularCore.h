@@ -10,6 +10,14 @@ public:
     CellularCore(CommunicationStandard* s): standard(s) {}
     int messagesPerUser() const { return standard->messagesPerUser(); }
     int overheadPer100() const { return standard->overheadPer100Messages(); }
+
+    // time one core shard spends on a message, overhead included
+    long long serviceTimeUs(long long msgsPerSec) const {
+        if (msgsPerSec <= 0) return 0;
+        long long num = 1000000LL * (100LL + overheadPer100());
+        long long den = msgsPerSec * 100LL;
+        return (num + den - 1) / den;
+    }
 };
 
 #endif
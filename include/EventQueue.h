@@ -0,0 +1,124 @@
+// EventQueue.h
+#pragma once
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+enum EventKind {
+    EV_GENERATE = 0,   // a user hands a message to its tower
+    EV_CORE = 1,       // message left its channel and reaches the tower's core
+    EV_DELIVER = 2     // message arrives from another tower over the backhaul
+};
+
+struct SimEvent {
+    long long time;
+    long long origin;  // when the message entered its source tower
+    int tower;         // logical process that handles the event
+    int srcTower;
+    int dstTower;
+    int user;
+    int seq;           // message number of the user
+    int kind;
+};
+
+// Total order on events. Every field that identifies the message takes part,
+// so the order never depends on insertion order and a tower sees its events
+// in the same sequence whether one or many threads run the simulation.
+inline bool eventBefore(const SimEvent& a, const SimEvent& b) {
+    if (a.time != b.time) return a.time < b.time;
+    if (a.kind != b.kind) return a.kind < b.kind;
+    if (a.srcTower != b.srcTower) return a.srcTower < b.srcTower;
+    if (a.user != b.user) return a.user < b.user;
+    if (a.seq != b.seq) return a.seq < b.seq;
+    return a.tower < b.tower;
+}
+
+// growable array of events; used as an outbox between worker threads
+class EventBuffer {
+    SimEvent* arr;
+    int cap;
+    int count;
+public:
+    EventBuffer(): arr(nullptr), cap(0), count(0) {}
+    ~EventBuffer() {
+        if (arr) delete [] arr;
+        arr = nullptr;
+    }
+
+    void reserve(int n) {
+        if (n <= cap) return;
+        SimEvent* newArr = new SimEvent[n];
+        for (int i = 0; i < count; ++i) newArr[i] = arr[i];
+        if (arr) delete [] arr;
+        arr = newArr;
+        cap = n;
+    }
+
+    void push(const SimEvent& e) {
+        if (count >= cap) reserve(cap == 0 ? 64 : cap * 2);
+        arr[count++] = e;
+    }
+
+    int size() const { return count; }
+    const SimEvent& at(int i) const { return arr[i]; }
+    void clear() { count = 0; }
+};
+
+// binary min-heap ordered by eventBefore()
+class EventQueue {
+    SimEvent* heap;
+    int cap;
+    int count;
+
+    void grow() {
+        int newCap = (cap == 0) ? 64 : cap * 2;
+        SimEvent* newHeap = new SimEvent[newCap];
+        for (int i = 0; i < count; ++i) newHeap[i] = heap[i];
+        if (heap) delete [] heap;
+        heap = newHeap;
+        cap = newCap;
+    }
+
+public:
+    EventQueue(): heap(nullptr), cap(0), count(0) {}
+    ~EventQueue() {
+        if (heap) delete [] heap;
+        heap = nullptr;
+    }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    const SimEvent& top() const { return heap[0]; }
+    void clear() { count = 0; }
+
+    void push(const SimEvent& e) {
+        if (count >= cap) grow();
+        int i = count++;
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!eventBefore(e, heap[parent])) break;
+            heap[i] = heap[parent];
+            i = parent;
+        }
+        heap[i] = e;
+    }
+
+    SimEvent pop() {
+        SimEvent result = heap[0];
+        SimEvent last = heap[--count];
+        int i = 0;
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= count) break;
+            if (child + 1 < count && eventBefore(heap[child + 1], heap[child])) child++;
+            if (!eventBefore(heap[child], last)) break;
+            heap[i] = heap[child];
+            i = child;
+        }
+        if (count > 0) heap[i] = last;
+        return result;
+    }
+};
+
+#endif
+
+//Kinshuk
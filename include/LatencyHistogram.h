@@ -0,0 +1,113 @@
+// LatencyHistogram.h
+#pragma once
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+// Log-linear (HDR-style) histogram of latencies in microseconds.
+// Values below 2*HALF get one bucket each; above that every power of two is
+// split into HALF linear sub-buckets, so the relative error is under 1/HALF
+// at any magnitude. Memory is fixed, record() is O(1), and histograms filled
+// by different threads are combined with merge().
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 6;
+    static const int HALF = 1 << (SUB_BITS - 1);               // 32 sub-buckets
+    static const int MAX_BITS = 40;                             // ~12.7 days in us
+    static const int BUCKETS = (MAX_BITS - SUB_BITS + 2) * HALF;
+
+private:
+    long long counts[BUCKETS];
+    long long total;
+    long long sum;
+    long long minVal;
+    long long maxVal;
+
+    static int indexOf(long long v) {
+        if (v < 0) v = 0;
+        if (v >= (1LL << MAX_BITS)) v = (1LL << MAX_BITS) - 1;
+        if (v < 2 * HALF) return (int)v;
+        int msb = 63 - __builtin_clzll((unsigned long long)v);
+        int shift = msb - (SUB_BITS - 1);
+        return shift * HALF + (int)(v >> shift);
+    }
+
+    // highest value that maps to bucket idx
+    static long long upperOf(int idx) {
+        if (idx < 2 * HALF) return idx;
+        int shift = idx / HALF - 1;
+        long long mant = idx - shift * HALF;
+        return (mant << shift) + (1LL << shift) - 1;
+    }
+
+public:
+    LatencyHistogram() { reset(); }
+
+    // width of the bucket holding v: the resolution of any percentile near v
+    static long long bucketWidth(long long v) {
+        int idx = indexOf(v);
+        if (idx < 2 * HALF) return 1;
+        return 1LL << (idx / HALF - 1);
+    }
+
+    void reset() {
+        for (int i = 0; i < BUCKETS; ++i) counts[i] = 0;
+        total = 0;
+        sum = 0;
+        minVal = 0;
+        maxVal = 0;
+    }
+
+    void record(long long v) {
+        counts[indexOf(v)]++;
+        if (total == 0 || v < minVal) minVal = v;
+        if (total == 0 || v > maxVal) maxVal = v;
+        total++;
+        sum += v;
+    }
+
+    void merge(const LatencyHistogram& o) {
+        if (o.total == 0) return;
+        for (int i = 0; i < BUCKETS; ++i) counts[i] += o.counts[i];
+        if (total == 0 || o.minVal < minVal) minVal = o.minVal;
+        if (total == 0 || o.maxVal > maxVal) maxVal = o.maxVal;
+        total += o.total;
+        sum += o.sum;
+    }
+
+    long long count() const { return total; }
+    long long min() const { return minVal; }
+    long long max() const { return maxVal; }
+    long long mean() const { return total ? sum / total : 0; }
+
+    // FNV-1a over the full contents; equal histograms give equal values
+    unsigned long long fingerprint() const {
+        unsigned long long h = 0xCBF29CE484222325ULL;
+        for (int i = 0; i < BUCKETS; ++i) {
+            h ^= (unsigned long long)counts[i];
+            h *= 0x100000001B3ULL;
+        }
+        h ^= (unsigned long long)sum;
+        h *= 0x100000001B3ULL;
+        return h;
+    }
+
+    // per10000: 5000 = p50, 9900 = p99, 9990 = p99.9
+    long long percentile(int per10000) const {
+        if (total == 0) return 0;
+        long long rank = (total * per10000 + 9999) / 10000;
+        if (rank < 1) rank = 1;
+        long long seen = 0;
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                long long v = upperOf(i);
+                return v < maxVal ? v : maxVal;
+            }
+        }
+        return maxVal;
+    }
+};
+
+#endif
+
+//Kinshuk
@@ -0,0 +1,118 @@
+// Replication.h
+#pragma once
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include "TowerNetwork.h"
+#include "ResultCache.h"
+
+// Welford's streaming mean / variance.
+class RunningStat {
+    long long n;
+    double avg;
+    double m2;
+public:
+    RunningStat(): n(0), avg(0.0), m2(0.0) {}
+
+    void add(double x) {
+        n++;
+        double delta = x - avg;
+        avg += delta / n;
+        m2 += delta * (x - avg);
+    }
+
+    long long count() const { return n; }
+    double mean() const { return avg; }
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0.0; }
+
+    // half-width of the 95% confidence interval of the mean (Student t).
+    // Exact t values up to df = 100, which covers REPLICAS_MAX; beyond that
+    // 1.96 + 2.37 / df is within 0.001 of the exact value.
+    double halfWidth95() const {
+        static const double t95[100] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+            2.040, 2.037, 2.035, 2.032, 2.030, 2.028, 2.026, 2.024, 2.023, 2.021,
+            2.020, 2.018, 2.017, 2.015, 2.014, 2.013, 2.012, 2.011, 2.010, 2.009,
+            2.008, 2.007, 2.006, 2.005, 2.004, 2.003, 2.002, 2.002, 2.001, 2.000,
+            2.000, 1.999, 1.998, 1.998, 1.997, 1.997, 1.996, 1.995, 1.995, 1.994,
+            1.994, 1.993, 1.993, 1.993, 1.992, 1.992, 1.991, 1.991, 1.990, 1.990,
+            1.990, 1.989, 1.989, 1.989, 1.988, 1.988, 1.988, 1.987, 1.987, 1.987,
+            1.986, 1.986, 1.986, 1.986, 1.985, 1.985, 1.985, 1.984, 1.984, 1.984
+        };
+        if (n < 2) return 0.0;
+        long long df = n - 1;
+        double t = (df <= 100) ? t95[df - 1] : 1.960 + 2.37 / df;
+        return t * __builtin_sqrt(variance() / n);
+    }
+};
+
+enum ReplicaMetric {
+    METRIC_THROUGHPUT = 0,   // delivered messages per simulated second
+    METRIC_DROP_PERCENT,
+    METRIC_P50_US,
+    METRIC_P99_US,
+    METRIC_P999_US,
+    METRIC_COUNT
+};
+
+inline const char* replica_metric_name(int m) {
+    switch (m) {
+        case METRIC_THROUGHPUT: return "throughput (msg/s)";
+        case METRIC_DROP_PERCENT: return "drops (%)";
+        case METRIC_P50_US: return "p50 latency (us)";
+        case METRIC_P99_US: return "p99 latency (us)";
+        case METRIC_P999_US: return "p99.9 latency (us)";
+    }
+    return "?";
+}
+
+struct ReplicationPolicy {
+    int minReplicas;
+    int maxReplicas;
+    double targetRelHalfWidth;   // e.g. 0.05 = CI of +/-5% of the mean
+    int workers;
+};
+
+struct ReplicationResult {
+    RunningStat metric[METRIC_COUNT];
+    int replicas;     // replicas folded into the statistics
+    int simulated;    // replicas that were not in the cache
+    bool converged;
+};
+
+// 95% CI half-width of a metric. Latency percentiles are histogram bucket
+// bounds, so replicas can agree exactly while the true value is anywhere in
+// the bucket; their precision is never reported finer than one bucket.
+inline double replica_half_width(const ReplicationResult& r, int m) {
+    double hw = r.metric[m].halfWidth95();
+    if (m == METRIC_P50_US || m == METRIC_P99_US || m == METRIC_P999_US) {
+        double mean = r.metric[m].mean();
+        double res = (double)LatencyHistogram::bucketWidth((long long)(mean > 0 ? mean : 0));
+        if (hw < res) hw = res;
+    }
+    return hw;
+}
+
+inline void cache_row_set_network(CacheRow& r, const NetworkStats& ns) {
+    r.delivered = ns.delivered;
+    r.dropped = ns.dropped;
+    r.crossTower = ns.crossTower;
+    r.simEndUs = ns.simEndUs;
+    cache_row_set_latency(r, ns.latency);
+}
+
+// Runs independent replicas of one scenario, replica r with seed base.seed + r,
+// on up to `workers` threads at a time. Each round starts only the replicas the
+// current worst metric suggests are still missing (n * (hw / target)^2 in
+// total, and at least minReplicas). Replicas are folded into the statistics in
+// seed order and the run stops at the first replica count where every metric
+// meets the target, so the answer does not depend on the number of cores.
+// baseKey identifies the scenario; each replica is cached under its own seed.
+void run_replications(const TrafficConfig& base, const CacheKey& baseKey, ResultCache& cache,
+                      const ReplicationPolicy& policy, ReplicationResult& out);
+
+#endif
+
+//Kinshuk
@@ -0,0 +1,134 @@
+// ResultCache.h
+#pragma once
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "CommunicationStandard.h"
+#include "LatencyHistogram.h"
+
+// Bump whenever the simulation model or the file layout changes. The
+// version is part of the default file name, so binaries built against
+// different layouts never open each other's files.
+#define RESULT_CACHE_VERSION 4
+#define RESULT_CACHE_SLOTS 16384
+
+#define RESULT_CACHE_STR2(x) #x
+#define RESULT_CACHE_STR(x) RESULT_CACHE_STR2(x)
+
+// relative to the working directory, like the binaries the Makefile builds
+#ifndef RESULT_CACHE_PATH
+#define RESULT_CACHE_PATH "cellsim-v" RESULT_CACHE_STR(RESULT_CACHE_VERSION) ".cache"
+#endif
+
+enum CacheRowKind {
+    CACHE_ROW_STANDARD = 1,   // capacity + single-tower latency of one standard
+    CACHE_ROW_NETWORK = 2     // multi-tower run
+};
+
+// Every input a cached result depends on. All fields are long long so the
+// struct has no padding and can be hashed and compared as raw words.
+struct CacheKey {
+    long long kind;
+    long long usersPerChannel;
+    long long messagesPerUser;
+    long long channelBandwidthKHz;
+    long long totalBandwidthKHz;
+    long long antennas;
+    long long speedMbpsTimes10;
+    long long overheadPer100;
+    long long users;
+    long long coreMsgCap;
+    long long shards;
+    long long towers;
+    long long seed;
+    long long messageBits;
+    long long coreMsgRate;
+    long long crossPercent;
+    long long maxHops;
+    long long hopLatencyUs;
+    long long coreQueueLimit;
+};
+
+struct CacheRow {
+    long long channels;
+    long long bandwidthCap;
+    long long coreCap;
+    long long users;
+    long long delivered;
+    long long dropped;
+    long long crossTower;
+    long long simEndUs;
+    long long latencyCount;
+    long long p50;
+    long long p90;
+    long long p99;
+    long long p999;
+    long long latencyMax;
+    long long latencyMean;
+};
+
+inline CacheKey make_cache_key(long long kind, const CommunicationStandard* s) {
+    CacheKey k = CacheKey();
+    k.kind = kind;
+    k.usersPerChannel = s->usersPerChannel();
+    k.messagesPerUser = s->messagesPerUser();
+    k.channelBandwidthKHz = s->channelBandwidthKHz();
+    k.totalBandwidthKHz = s->totalBandwidthKHz();
+    k.antennas = s->antennas();
+    k.speedMbpsTimes10 = s->speedMbpsTimes10();
+    k.overheadPer100 = s->overheadPer100Messages();
+    return k;
+}
+
+inline void cache_row_set_latency(CacheRow& r, const LatencyHistogram& h) {
+    r.latencyCount = h.count();
+    r.p50 = h.percentile(5000);
+    r.p90 = h.percentile(9000);
+    r.p99 = h.percentile(9900);
+    r.p999 = h.percentile(9990);
+    r.latencyMax = h.max();
+    r.latencyMean = h.mean();
+}
+
+struct CacheFileHeader;
+struct CacheSlot;
+
+// Content-addressed result store shared by every run that uses the same cache
+// file (by default, runs started from the same directory). The file is a
+// fixed-size open-addressing hash table mapped with MAP_SHARED; lookups read
+// it directly, inserts are serialised with flock() and skipped if the lock
+// cannot be taken. An existing file is never truncated or reinitialised: if
+// it cannot be opened, locked or has another layout, the cache stays closed
+// and every lookup misses.
+class ResultCache {
+    CacheFileHeader* header;
+    CacheSlot* slots;
+    long mapBytes;
+    int fd;
+    long long hits;
+    long long misses;
+    const char* failure;
+
+public:
+    ResultCache(): header(nullptr), slots(nullptr), mapBytes(0), fd(-1), hits(0), misses(0),
+                   failure("not opened") {}
+    ~ResultCache() { close(); }
+
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+    const char* failureReason() const { return failure; }
+
+    bool lookup(const CacheKey& key, CacheRow& out);
+    void store(const CacheKey& key, const CacheRow& row);
+
+    // no free slot left; new points are no longer stored
+    bool isFull() const;
+
+    long long hitCount() const { return hits; }
+    long long missCount() const { return misses; }
+};
+
+#endif
+
+//Kinshuk
@@ -0,0 +1,44 @@
+// TowerNetwork.h
+#pragma once
+#ifndef TOWER_NETWORK_H
+#define TOWER_NETWORK_H
+
+#include "TowerProcess.h"
+#include "LatencyHistogram.h"
+
+struct NetworkStats {
+    long long delivered;
+    long long dropped;
+    long long crossTower;
+    long long simEndUs;         // last core completion on any tower
+    long long windows;          // synchronisation rounds (parallel run only)
+    int workers;                // threads that actually ran
+    long long wallUs;
+    unsigned long long digest;  // fingerprint of every tower's final state
+    LatencyHistogram latency;
+};
+
+// A ring of towers, each a TowerProcess. runSequential() drives every tower
+// from one global event queue; runParallel() gives each worker thread a block
+// of towers and advances all of them in windows of one hop latency, the
+// smallest delay any event can have on its way to another tower.
+class TowerNetwork {
+    TrafficConfig cfg;
+    TowerProcess* towers;
+
+    void reset();
+    void collect(NetworkStats& out) const;
+
+public:
+    TowerNetwork(const TrafficConfig& c);
+    ~TowerNetwork();
+
+    long long lookaheadUs() const { return cfg.hopLatencyUs; }
+
+    void runSequential(NetworkStats& out);
+    void runParallel(int workers, NetworkStats& out);
+};
+
+#endif
+
+//Kinshuk
@@ -0,0 +1,176 @@
+// TowerProcess.h
+#pragma once
+#ifndef TOWER_PROCESS_H
+#define TOWER_PROCESS_H
+
+#include "EventQueue.h"
+#include "LatencyHistogram.h"
+
+// Everything a multi-tower run needs, derived once from the chosen standard.
+struct TrafficConfig {
+    int towers;
+    int usersPerTower;
+    int msgsPerUser;
+    int perChanCap;
+    int antennas;
+    int slots;
+    long long slotUs;
+    long long serviceUs;
+    unsigned long long seed;
+    int crossPercent;       // share of messages addressed to another tower
+    int maxHops;            // farthest destination along the tower ring
+    long long hopLatencyUs; // backhaul latency per hop
+    int coreQueueLimit;     // messages a core buffers before it drops
+};
+
+// splitmix64 over the message identity; the only source of randomness
+inline unsigned long long traffic_hash(unsigned long long seed, int tower, int user, int seq) {
+    unsigned long long z = seed
+        ^ ((unsigned long long)(unsigned)tower << 40)
+        ^ ((unsigned long long)(unsigned)user << 16)
+        ^ (unsigned long long)(unsigned)seq;
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// One tower plus its users, simulated as a logical process. All state a
+// tower owns is touched only from handle(), and handle() only emits events
+// for other towers at least one hop latency in the future, which is what
+// lets towers run on different threads between synchronisation points.
+class TowerProcess {
+    const TrafficConfig* cfg;
+    int id;
+    long long coreFree;
+    long long* userNextFrame;   // first frame whose slot the user may still use
+    EventQueue pending;         // used when a worker thread owns this tower
+    LatencyHistogram latency;
+    long long delivered;
+    long long dropped;
+    long long crossSent;
+
+    long long frameUs() const { return cfg->slots * cfg->slotUs; }
+
+    long long generateTime(int user, int seq) const {
+        long long f = frameUs();
+        long long jitter = f > 0 ? (long long)(traffic_hash(cfg->seed, id, user, seq) % (unsigned long long)f) : 0;
+        return seq * f + jitter;
+    }
+
+public:
+    TowerProcess(): cfg(nullptr), id(0), coreFree(0), userNextFrame(nullptr),
+                    delivered(0), dropped(0), crossSent(0) {}
+    ~TowerProcess() {
+        if (userNextFrame) delete [] userNextFrame;
+        userNextFrame = nullptr;
+    }
+
+    void init(const TrafficConfig* c, int towerId) {
+        cfg = c;
+        id = towerId;
+        coreFree = 0;
+        delivered = 0;
+        dropped = 0;
+        crossSent = 0;
+        latency.reset();
+        pending.clear();
+        if (userNextFrame) delete [] userNextFrame;
+        userNextFrame = new long long[cfg->usersPerTower];
+        for (int u = 0; u < cfg->usersPerTower; ++u) userNextFrame[u] = 0;
+    }
+
+    SimEvent firstEvent(int user) const {
+        SimEvent e;
+        e.time = generateTime(user, 0);
+        e.origin = e.time;
+        e.tower = id;
+        e.srcTower = id;
+        e.dstTower = id;
+        e.user = user;
+        e.seq = 0;
+        e.kind = EV_GENERATE;
+        return e;
+    }
+
+    long long linkLatencyUs(int other) const {
+        int d = other - id;
+        if (d < 0) d = -d;
+        if (cfg->towers - d < d) d = cfg->towers - d;
+        return d * cfg->hopLatencyUs;
+    }
+
+    // processes one event; writes up to two follow-up events into out
+    int handle(const SimEvent& e, SimEvent* out) {
+        int n = 0;
+
+        if (e.kind == EV_GENERATE) {
+            // wait for the user's TDMA slot, then transmit
+            long long f = frameUs();
+            int slot = (e.user % cfg->perChanCap) / cfg->antennas;
+            long long frame = f > 0 ? e.time / f : 0;
+            if (e.time > frame * f + slot * cfg->slotUs) frame++;
+            if (frame < userNextFrame[e.user]) frame = userNextFrame[e.user];
+            userNextFrame[e.user] = frame + 1;
+
+            unsigned long long r = traffic_hash(cfg->seed ^ 0xD1B54A32D192ED03ULL, id, e.user, e.seq);
+            int dst = id;
+            int reach = cfg->maxHops < cfg->towers - 1 ? cfg->maxHops : cfg->towers - 1;
+            if (reach > 0 && (int)(r % 100) < cfg->crossPercent) {
+                int hops = 1 + (int)((r >> 8) % (unsigned long long)reach);
+                dst = ((r >> 32) & 1) ? id + hops : id - hops;
+                dst = ((dst % cfg->towers) + cfg->towers) % cfg->towers;
+            }
+
+            out[n] = e;
+            out[n].time = frame * f + (slot + 1) * cfg->slotUs;
+            out[n].dstTower = dst;
+            out[n].kind = EV_CORE;
+            n++;
+
+            if (e.seq + 1 < cfg->msgsPerUser) {
+                out[n] = e;
+                out[n].seq = e.seq + 1;
+                out[n].time = generateTime(e.user, e.seq + 1);
+                out[n].origin = out[n].time;
+                n++;
+            }
+            return n;
+        }
+
+        // EV_CORE and EV_DELIVER both queue FIFO at this tower's core
+        long long backlog = coreFree > e.time ? coreFree - e.time : 0;
+        if (backlog >= cfg->coreQueueLimit * cfg->serviceUs) {
+            dropped++;
+            return 0;
+        }
+        long long begin = coreFree > e.time ? coreFree : e.time;
+        coreFree = begin + cfg->serviceUs;
+
+        if (e.kind == EV_CORE && e.dstTower != id) {
+            crossSent++;
+            out[n] = e;
+            out[n].time = coreFree + linkLatencyUs(e.dstTower);
+            out[n].tower = e.dstTower;
+            out[n].kind = EV_DELIVER;
+            n++;
+            return n;
+        }
+
+        delivered++;
+        latency.record(coreFree - e.origin);
+        return n;
+    }
+
+    EventQueue& queue() { return pending; }
+
+    long long coreFreeAt() const { return coreFree; }
+    long long deliveredCount() const { return delivered; }
+    long long droppedCount() const { return dropped; }
+    long long crossSentCount() const { return crossSent; }
+    const LatencyHistogram& latencyHistogram() const { return latency; }
+};
+
+#endif
+
+//Kinshuk
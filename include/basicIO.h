@@ -9,6 +9,7 @@ int inputint();
 const char* inputstring();
 void inputstring(char* buffer, int size);
 void outputint(int value);
+void outputlong(long long value);
 void outputstring(const char* text);
 void terminate();
 void errorstring(const char* text);
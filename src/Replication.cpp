@@ -0,0 +1,143 @@
+#include "../include/Replication.h"
+#include "../include/Exception.h"
+
+#include <pthread.h>
+
+struct ReplicaJob {
+    TrafficConfig cfg;
+    NetworkStats stats;
+};
+
+static void* replica_worker(void* v) {
+    ReplicaJob* job = (ReplicaJob*)v;
+    TowerNetwork net(job->cfg);
+    net.runSequential(job->stats);
+    return nullptr;
+}
+
+static void add_replica(ReplicationResult& out, const CacheRow& r) {
+    long long offered = r.delivered + r.dropped;
+    double throughput = r.simEndUs > 0 ? (double)r.delivered * 1000000.0 / r.simEndUs : 0.0;
+    double dropPct = offered > 0 ? (double)r.dropped * 100.0 / offered : 0.0;
+
+    out.metric[METRIC_THROUGHPUT].add(throughput);
+    out.metric[METRIC_DROP_PERCENT].add(dropPct);
+    out.metric[METRIC_P50_US].add((double)r.p50);
+    out.metric[METRIC_P99_US].add((double)r.p99);
+    out.metric[METRIC_P999_US].add((double)r.p999);
+    out.replicas++;
+}
+
+static bool precise_enough(const ReplicationResult& out, const ReplicationPolicy& p) {
+    if (out.replicas < p.minReplicas) return false;
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        double mean = out.metric[m].mean();
+        if (mean < 0) mean = -mean;
+        if (replica_half_width(out, m) > p.targetRelHalfWidth * mean) return false;
+    }
+    return true;
+}
+
+// Replicas still needed before the target can be met. The half-width shrinks
+// like 1/sqrt(n), so the worst metric needs about n * (hw / target)^2 in total.
+static int replicas_wanted(const ReplicationResult& out, const ReplicationPolicy& p) {
+    int n = out.replicas;
+    if (n < p.minReplicas) return p.minReplicas - n;
+
+    double want = n;
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        double mean = out.metric[m].mean();
+        if (mean < 0) mean = -mean;
+        double hw = replica_half_width(out, m);
+        double target = p.targetRelHalfWidth * mean;
+        if (hw <= target) continue;
+        if (target <= 0) return p.maxReplicas;
+        double r = hw / target;
+        if (n * r * r > want) want = n * r * r;
+    }
+    if (want >= p.maxReplicas) return p.maxReplicas;
+    int more = (int)want - n;
+    if ((double)(int)want < want) more++;
+    return more > 0 ? more : 1;
+}
+
+void run_replications(const TrafficConfig& base, const CacheKey& baseKey, ResultCache& cache,
+                      const ReplicationPolicy& policy, ReplicationResult& out) {
+    if (base.towers <= 0 || base.usersPerTower <= 0)
+        throw InvalidInputException("Replication needs at least one tower and one user");
+
+    for (int m = 0; m < METRIC_COUNT; ++m) out.metric[m] = RunningStat();
+    out.replicas = 0;
+    out.simulated = 0;
+    out.converged = false;
+
+    int batch = policy.workers > 0 ? policy.workers : 1;
+    ReplicaJob* jobs = new ReplicaJob[batch];
+    CacheRow* rows = new CacheRow[batch];
+    bool* cached = new bool[batch];
+    pthread_t* tarr = new pthread_t[batch];
+
+    int next = 0;
+    while (next < policy.maxReplicas && !out.converged) {
+        // start no more replicas than the current estimate asks for, so a
+        // scenario that converges early does not simulate a full batch
+        int count = replicas_wanted(out, policy);
+        if (count > policy.maxReplicas - next) count = policy.maxReplicas - next;
+        if (count > batch) count = batch;
+
+        // look everything up first, then simulate only the misses
+        int started = 0;
+        bool failed = false;
+        for (int j = 0; j < count; ++j) {
+            CacheKey key = baseKey;
+            key.seed = (long long)(base.seed + next + j);
+            cached[j] = cache.lookup(key, rows[j]);
+            if (cached[j]) continue;
+
+            jobs[j].cfg = base;
+            jobs[j].cfg.seed = base.seed + next + j;
+            if (pthread_create(&tarr[j], NULL, replica_worker, &jobs[j]) != 0) {
+                failed = true;
+                count = j;   // only wait for the replicas already running
+                break;
+            }
+            started++;
+        }
+
+        for (int j = 0; j < count; ++j) {
+            if (cached[j]) continue;
+            pthread_join(tarr[j], NULL);
+            if (failed) continue;
+
+            rows[j] = CacheRow();
+            rows[j].users = base.usersPerTower;
+            cache_row_set_network(rows[j], jobs[j].stats);
+
+            CacheKey key = baseKey;
+            key.seed = (long long)(base.seed + next + j);
+            cache.store(key, rows[j]);
+        }
+        if (failed) {
+            delete[] jobs;
+            delete[] rows;
+            delete[] cached;
+            delete[] tarr;
+            throw ThreadException("Failed to create thread");
+        }
+        out.simulated += started;
+
+        // fold in seed order; replicas past the stopping point are discarded
+        for (int j = 0; j < count && !out.converged; ++j) {
+            add_replica(out, rows[j]);
+            out.converged = precise_enough(out, policy);
+        }
+        next += count;
+    }
+
+    delete[] jobs;
+    delete[] rows;
+    delete[] cached;
+    delete[] tarr;
+}
+
+//Kinshuk
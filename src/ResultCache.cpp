@@ -0,0 +1,195 @@
+#include "../include/ResultCache.h"
+
+#define SYS_CLOSE 3
+#define SYS_LSEEK 8
+#define SYS_MMAP 9
+#define SYS_MUNMAP 11
+#define SYS_FLOCK 73
+#define SYS_FTRUNCATE 77
+#define SYS_OPEN 2
+
+#define O_RDWR_CREAT 0102   // O_RDWR | O_CREAT
+#define SEEK_END_POS 2
+#define PROT_RW 3           // PROT_READ | PROT_WRITE
+#define MAP_SHARED_FLAG 1
+#define LOCK_EX_FLAG 2
+#define LOCK_UN_FLAG 8
+
+#define CACHE_MAGIC 0x45484341434D4953ULL   // "SIMCACHE"
+#define SLOT_EMPTY 0
+#define SLOT_FULL 1
+
+extern "C" long syscall3(long number, long arg1, long arg2, long arg3);
+extern "C" long syscall6(long number, long arg1, long arg2, long arg3,
+                         long arg4, long arg5, long arg6);
+
+struct CacheFileHeader {
+    unsigned long long magic;
+    long long version;
+    long long slotCount;
+    long long used;
+    long long maxProbe;   // longest probe distance of any stored row
+};
+
+struct CacheSlot {
+    unsigned long long hash;
+    long long state;
+    CacheKey key;
+    CacheRow row;
+};
+
+static const int KEY_WORDS = sizeof(CacheKey) / sizeof(long long);
+
+static unsigned long long key_hash(const CacheKey& k) {
+    const long long* w = (const long long*)&k;
+    unsigned long long h = 0xCBF29CE484222325ULL;
+    for (int i = 0; i < KEY_WORDS; ++i) {
+        h ^= (unsigned long long)w[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+static bool key_equal(const CacheKey& a, const CacheKey& b) {
+    const long long* wa = (const long long*)&a;
+    const long long* wb = (const long long*)&b;
+    for (int i = 0; i < KEY_WORDS; ++i)
+        if (wa[i] != wb[i]) return false;
+    return true;
+}
+
+// raw syscalls return -errno on failure
+static bool sys_failed(long r) { return r < 0 && r > -4096; }
+
+bool ResultCache::open(const char* path) {
+    close();
+
+    long f = syscall3(SYS_OPEN, (long)path, O_RDWR_CREAT, 0644);
+    if (sys_failed(f)) {
+        failure = "cannot open file";
+        return false;
+    }
+    fd = (int)f;
+
+    long bytes = (long)sizeof(CacheFileHeader) + (long)sizeof(CacheSlot) * RESULT_CACHE_SLOTS;
+    // without the lock another run could be sizing or initialising the file
+    if (sys_failed(syscall3(SYS_FLOCK, fd, LOCK_EX_FLAG, 0))) {
+        failure = "cannot lock file";
+        close();
+        return false;
+    }
+
+    // Only an empty file (just created, or left by a run that died before
+    // sizing it) is set up here. Anything else belongs to some binary, maybe
+    // one that has it mapped right now, so it is used as-is or not at all.
+    long size = syscall3(SYS_LSEEK, fd, 0, SEEK_END_POS);
+    if (sys_failed(size)) {
+        failure = "cannot read file size";
+        syscall3(SYS_FLOCK, fd, LOCK_UN_FLAG, 0);
+        close();
+        return false;
+    }
+    if (size == 0 && sys_failed(syscall3(SYS_FTRUNCATE, fd, bytes, 0))) {
+        failure = "cannot size file";
+        syscall3(SYS_FLOCK, fd, LOCK_UN_FLAG, 0);
+        close();
+        return false;
+    }
+    if (size != 0 && size != bytes) {
+        failure = "file has another layout";
+        syscall3(SYS_FLOCK, fd, LOCK_UN_FLAG, 0);
+        close();
+        return false;
+    }
+
+    long p = syscall6(SYS_MMAP, 0, bytes, PROT_RW, MAP_SHARED_FLAG, fd, 0);
+    if (sys_failed(p)) {
+        failure = "cannot map file";
+        syscall3(SYS_FLOCK, fd, LOCK_UN_FLAG, 0);
+        close();
+        return false;
+    }
+    mapBytes = bytes;
+    header = (CacheFileHeader*)p;
+    slots = (CacheSlot*)(header + 1);
+
+    if (header->magic == 0) {
+        // zero-filled by ftruncate: slots are already empty
+        header->version = RESULT_CACHE_VERSION;
+        header->slotCount = RESULT_CACHE_SLOTS;
+        header->used = 0;
+        header->maxProbe = 0;
+        __atomic_store_n(&header->magic, CACHE_MAGIC, __ATOMIC_RELEASE);
+    } else if (header->magic != CACHE_MAGIC || header->version != RESULT_CACHE_VERSION ||
+               header->slotCount != RESULT_CACHE_SLOTS) {
+        syscall3(SYS_FLOCK, fd, LOCK_UN_FLAG, 0);
+        close();
+        failure = "file has another layout";
+        return false;
+    }
+
+    syscall3(SYS_FLOCK, fd, LOCK_UN_FLAG, 0);
+    failure = nullptr;
+    return true;
+}
+
+bool ResultCache::isFull() const {
+    return header && __atomic_load_n(&header->used, __ATOMIC_RELAXED) >= RESULT_CACHE_SLOTS;
+}
+
+void ResultCache::close() {
+    if (header) syscall3(SYS_MUNMAP, (long)header, mapBytes, 0);
+    if (fd >= 0) syscall3(SYS_CLOSE, fd, 0, 0);
+    header = nullptr;
+    slots = nullptr;
+    mapBytes = 0;
+    fd = -1;
+}
+
+bool ResultCache::lookup(const CacheKey& key, CacheRow& out) {
+    if (!header) {
+        misses++;
+        return false;
+    }
+    unsigned long long h = key_hash(key);
+    // a stored key is never further than maxProbe from its home slot
+    long long limit = __atomic_load_n(&header->maxProbe, __ATOMIC_ACQUIRE) + 1;
+    if (limit > RESULT_CACHE_SLOTS) limit = RESULT_CACHE_SLOTS;
+    for (int probe = 0; probe < limit; ++probe) {
+        CacheSlot& s = slots[(h + probe) % RESULT_CACHE_SLOTS];
+        if (__atomic_load_n(&s.state, __ATOMIC_ACQUIRE) == SLOT_EMPTY) break;
+        if (s.hash == h && key_equal(s.key, key)) {
+            out = s.row;
+            hits++;
+            return true;
+        }
+    }
+    misses++;
+    return false;
+}
+
+void ResultCache::store(const CacheKey& key, const CacheRow& row) {
+    if (!header) return;
+    unsigned long long h = key_hash(key);
+
+    // an unlocked insert could race another run for the same empty slot
+    if (sys_failed(syscall3(SYS_FLOCK, fd, LOCK_EX_FLAG, 0))) return;
+    for (int probe = 0; probe < RESULT_CACHE_SLOTS && header->used < RESULT_CACHE_SLOTS; ++probe) {
+        CacheSlot& s = slots[(h + probe) % RESULT_CACHE_SLOTS];
+        if (s.state == SLOT_EMPTY) {
+            s.hash = h;
+            s.key = key;
+            s.row = row;
+            // publish last so lock-free readers never see a half-written row
+            if (probe > header->maxProbe)
+                __atomic_store_n(&header->maxProbe, (long long)probe, __ATOMIC_RELEASE);
+            __atomic_store_n(&s.state, (long long)SLOT_FULL, __ATOMIC_RELEASE);
+            header->used++;
+            break;
+        }
+        if (s.hash == h && key_equal(s.key, key)) break;   // another run got here first
+    }
+    syscall3(SYS_FLOCK, fd, LOCK_UN_FLAG, 0);
+}
+
+//Kinshuk
@@ -0,0 +1,234 @@
+#include "../include/TowerNetwork.h"
+#include "../include/Exception.h"
+
+#include <pthread.h>
+
+#define SYS_CLOCK_GETTIME 228
+#define CLOCK_MONOTONIC_ID 1
+
+extern "C" long syscall3(long number, long arg1, long arg2, long arg3);
+
+static const long long TIME_INFINITY = 0x7FFFFFFFFFFFFFFFLL;
+
+static long long now_us() {
+    long ts[2] = {0, 0};
+    syscall3(SYS_CLOCK_GETTIME, CLOCK_MONOTONIC_ID, (long)ts, 0);
+    return (long long)ts[0] * 1000000LL + ts[1] / 1000;
+}
+
+TowerNetwork::TowerNetwork(const TrafficConfig& c): cfg(c), towers(nullptr) {
+    if (cfg.towers <= 0 || cfg.usersPerTower <= 0)
+        throw InvalidInputException("Tower network needs at least one tower and one user");
+    if (cfg.hopLatencyUs <= 0)
+        throw InvalidInputException("Inter-tower latency must be positive");
+    towers = new TowerProcess[cfg.towers];
+}
+
+TowerNetwork::~TowerNetwork() {
+    if (towers) delete [] towers;
+    towers = nullptr;
+}
+
+void TowerNetwork::reset() {
+    for (int k = 0; k < cfg.towers; ++k) towers[k].init(&cfg, k);
+}
+
+void TowerNetwork::collect(NetworkStats& out) const {
+    out.delivered = 0;
+    out.dropped = 0;
+    out.crossTower = 0;
+    out.simEndUs = 0;
+    out.latency.reset();
+
+    unsigned long long h = 0xCBF29CE484222325ULL;
+    for (int k = 0; k < cfg.towers; ++k) {
+        const TowerProcess& tp = towers[k];
+        out.delivered += tp.deliveredCount();
+        out.dropped += tp.droppedCount();
+        out.crossTower += tp.crossSentCount();
+        out.latency.merge(tp.latencyHistogram());
+        if (tp.coreFreeAt() > out.simEndUs) out.simEndUs = tp.coreFreeAt();
+
+        unsigned long long parts[5] = {
+            (unsigned long long)tp.coreFreeAt(),
+            (unsigned long long)tp.deliveredCount(),
+            (unsigned long long)tp.droppedCount(),
+            (unsigned long long)tp.crossSentCount(),
+            tp.latencyHistogram().fingerprint()
+        };
+        for (int i = 0; i < 5; ++i) {
+            h ^= parts[i];
+            h *= 0x100000001B3ULL;
+        }
+    }
+    out.digest = h;
+}
+
+// ==================== Sequential =====================
+void TowerNetwork::runSequential(NetworkStats& out) {
+    long long t0 = now_us();
+    reset();
+
+    EventQueue q;
+    for (int k = 0; k < cfg.towers; ++k)
+        for (int u = 0; u < cfg.usersPerTower; ++u)
+            q.push(towers[k].firstEvent(u));
+
+    SimEvent next[2];
+    while (!q.empty()) {
+        SimEvent e = q.pop();
+        int n = towers[e.tower].handle(e, next);
+        for (int i = 0; i < n; ++i) q.push(next[i]);
+    }
+
+    collect(out);
+    out.windows = 0;
+    out.workers = 1;
+    out.wallUs = now_us() - t0;
+}
+
+// ==================== Parallel =====================
+// Every window [start, start + lookahead) is safe: an event handled inside it
+// can only reach another tower at or after start + lookahead. Workers hand
+// such events over through per-pair outboxes; outbox[from][to] is written by
+// one worker during the compute phase and read by one worker after the
+// barrier, so no locks are needed.
+struct ParallelShared {
+    TowerProcess* towers;
+    const TrafficConfig* cfg;
+    int workers;
+    int* ownerOf;             // tower -> worker
+    EventBuffer* outbox;      // [from * workers + to]
+    long long* localMin;      // earliest pending event per worker
+    long long windows;
+    pthread_mutex_t startGate;  // held until the worker count is final
+    pthread_barrier_t barrier;
+};
+
+struct ParallelWorker {
+    ParallelShared* sh;
+    int index;
+    int firstTower;
+    int endTower;
+};
+
+static long long earliest_pending(ParallelShared* sh, int lo, int hi) {
+    long long m = TIME_INFINITY;
+    for (int k = lo; k < hi; ++k) {
+        EventQueue& q = sh->towers[k].queue();
+        if (!q.empty() && q.top().time < m) m = q.top().time;
+    }
+    return m;
+}
+
+static void* lp_worker(void* v) {
+    ParallelWorker* pw = (ParallelWorker*)v;
+    ParallelShared* sh = pw->sh;
+    pthread_mutex_lock(&sh->startGate);
+    pthread_mutex_unlock(&sh->startGate);
+
+    int w = pw->index;
+    int W = sh->workers;
+    long long lookahead = sh->cfg->hopLatencyUs;
+
+    for (int k = pw->firstTower; k < pw->endTower; ++k)
+        for (int u = 0; u < sh->cfg->usersPerTower; ++u)
+            sh->towers[k].queue().push(sh->towers[k].firstEvent(u));
+
+    sh->localMin[w] = earliest_pending(sh, pw->firstTower, pw->endTower);
+    pthread_barrier_wait(&sh->barrier);
+
+    SimEvent next[2];
+    while (true) {
+        long long start = TIME_INFINITY;
+        for (int i = 0; i < W; ++i)
+            if (sh->localMin[i] < start) start = sh->localMin[i];
+        if (start == TIME_INFINITY) break;
+        long long end = start + lookahead;
+        if (w == 0) sh->windows++;
+
+        for (int k = pw->firstTower; k < pw->endTower; ++k) {
+            TowerProcess& tp = sh->towers[k];
+            EventQueue& q = tp.queue();
+            while (!q.empty() && q.top().time < end) {
+                SimEvent e = q.pop();
+                int n = tp.handle(e, next);
+                for (int i = 0; i < n; ++i) {
+                    int owner = sh->ownerOf[next[i].tower];
+                    if (owner == w) sh->towers[next[i].tower].queue().push(next[i]);
+                    else sh->outbox[w * W + owner].push(next[i]);
+                }
+            }
+        }
+        pthread_barrier_wait(&sh->barrier);
+
+        for (int from = 0; from < W; ++from) {
+            EventBuffer& box = sh->outbox[from * W + w];
+            for (int i = 0; i < box.size(); ++i)
+                sh->towers[box.at(i).tower].queue().push(box.at(i));
+            box.clear();
+        }
+        sh->localMin[w] = earliest_pending(sh, pw->firstTower, pw->endTower);
+        pthread_barrier_wait(&sh->barrier);
+    }
+    return nullptr;
+}
+
+void TowerNetwork::runParallel(int workers, NetworkStats& out) {
+    if (workers > cfg.towers) workers = cfg.towers;
+    if (workers <= 0) workers = 1;
+
+    long long t0 = now_us();
+    reset();
+
+    ParallelShared sh;
+    sh.towers = towers;
+    sh.cfg = &cfg;
+    sh.ownerOf = new int[cfg.towers];
+    sh.outbox = new EventBuffer[workers * workers];
+    sh.localMin = new long long[workers];
+    sh.windows = 0;
+    pthread_mutex_init(&sh.startGate, NULL);
+
+    // Threads wait on startGate before touching shared state, so if some
+    // cannot be created the run shrinks to the ones that were.
+    ParallelWorker* pw = new ParallelWorker[workers];
+    pthread_t* tarr = new pthread_t[workers];
+    pthread_mutex_lock(&sh.startGate);
+    int created = 1;
+    for (int w = 1; w < workers; ++w) {
+        pw[w].sh = &sh;
+        if (pthread_create(&tarr[w], NULL, lp_worker, &pw[w]) != 0) break;
+        created++;
+    }
+    workers = created;
+    sh.workers = workers;
+
+    for (int w = 0; w < workers; ++w) {
+        pw[w].sh = &sh;
+        pw[w].index = w;
+        pw[w].firstTower = (int)((long long)cfg.towers * w / workers);
+        pw[w].endTower = (int)((long long)cfg.towers * (w + 1) / workers);
+        for (int k = pw[w].firstTower; k < pw[w].endTower; ++k) sh.ownerOf[k] = w;
+    }
+    pthread_barrier_init(&sh.barrier, NULL, workers);
+    pthread_mutex_unlock(&sh.startGate);
+
+    lp_worker(&pw[0]);
+    for (int w = 1; w < workers; ++w) pthread_join(tarr[w], NULL);
+
+    pthread_barrier_destroy(&sh.barrier);
+    pthread_mutex_destroy(&sh.startGate);
+    collect(out);
+    out.windows = sh.windows;
+    out.workers = workers;
+    out.wallUs = now_us() - t0;
+
+    delete[] tarr;
+    delete[] pw;
+    delete[] sh.ownerOf;
+    delete[] sh.outbox;
+    delete[] sh.localMin;
+}
+
+//Kinshuk
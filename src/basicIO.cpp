@@ -77,6 +77,30 @@ void basicIO::outputint(int number) {
     }
 }
 
+void basicIO::outputlong(long long number) {
+    char buffer[32];
+    int i = 0;
+    bool isNegative = false;
+    if (number == 0) {
+        buffer[i++] = '0';
+    } else {
+        if (number < 0) {
+            isNegative = true;
+            number = -number;
+        }
+        while (number > 0) {
+            buffer[i++] = '0' + (number % 10);
+            number /= 10;
+        }
+        if (isNegative) {
+            buffer[i++] = '-';
+        }
+    }
+    for (int j = i - 1; j >= 0; --j) {
+        syscall3(SYS_WRITE, STDOUT, (long)&buffer[j], 1);
+    }
+}
+
 void basicIO::outputstring(const char* text) {
     long len = 0;
     while (text[len]) ++len;
@@ -11,6 +11,10 @@
 #include "../include/Exception.h"
 #include "../include/TemplateUtilities.h"
 #include "../include/ChannelRange.h"
+#include "../include/LatencyHistogram.h"
+#include "../include/TowerNetwork.h"
+#include "../include/ResultCache.h"
+#include "../include/Replication.h"
 
 #include <pthread.h>
 #include <unistd.h>   // sysconf()
@@ -22,6 +26,18 @@ static long long div_up(long long a, long long b) {
 }
 
 const long long CORE_MSG_RATE = 1000LL;
+const int CORE_SHARDS = 4;               // simulated core = 4 shards of CORE_MSG_RATE
+const long long MESSAGE_BITS = 1024LL;   // size of one simulated message
+
+// multi-tower scenario
+const int CROSS_TOWER_PERCENT = 20;
+const int MAX_HOPS = 3;
+const long long HOP_LATENCY_US = 2000LL;
+const int CORE_QUEUE_LIMIT = 1000;
+
+// Monte Carlo replication
+const int REPLICAS_MIN = 5;
+const int REPLICAS_MAX = 100;
 
 // sequential simulated time (1 core)
 static long long simulated_time_ms_nonthread(long long totalMsgs) {
@@ -35,30 +51,272 @@ struct WorkerArg {
     int startIndex;
     int endIndex;
     int msgsPerUser;
+    // core shards firstShard, firstShard + shardStride, ... owned by this
+    // thread; shardStart has the first user of every shard plus one past the
+    // last user
+    const int* shardStart;
+    int firstShard;
+    int shardStride;
+    // per-message timing model
+    int perChanCap;
+    int antennas;
+    int slots;
+    long long slotUs;
+    long long serviceUs;
 };
 
 struct WorkerResult {
     int usersProcessed;
     long long messagesProcessed;
+    LatencyHistogram* shardLatency;    // shards owned by the thread, in dealing order
+    int shardCount;
+    LatencyHistogram* channelLatency;  // channels touched by the thread, from firstChannel
+    int firstChannel;
+    int channelCount;
 };
 
+// Message m of every user reaches the tower at the start of frame m, queues
+// for the user's TDMA slot, is transmitted, and then waits FIFO for its core
+// shard. Messages are visited in slot order so each shard queue sees them in
+// the order they leave the channels.
+static void simulate_shard(const WorkerArg* a, int startUser, int endUser,
+                           LatencyHistogram& shard, LatencyHistogram* chan, int chanBase) {
+    if (endUser <= startUser) return;
+
+    int chFirst = startUser / a->perChanCap;
+    int chLast = (endUser - 1) / a->perChanCap;
+    long long frameUs = a->slots * a->slotUs;
+    long long coreFree = 0;
+
+    for (int m = 0; m < a->msgsPerUser; m++) {
+        long long arrival = m * frameUs;
+        for (int s = 0; s < a->slots; s++) {
+            long long depart = arrival + (s + 1) * a->slotUs;
+            for (int ch = chFirst; ch <= chLast; ch++) {
+                int base = ch * a->perChanCap + s * a->antennas;
+                for (int k = 0; k < a->antennas; k++) {
+                    int u = base + k;
+                    if (u < startUser || u >= endUser) continue;
+
+                    long long begin = depart > coreFree ? depart : coreFree;
+                    coreFree = begin + a->serviceUs;
+                    long long lat = coreFree - arrival;
+                    shard.record(lat);
+                    chan[ch - chanBase].record(lat);
+                }
+            }
+        }
+    }
+}
+
 void* worker_func(void* v) {
     WorkerArg* a = (WorkerArg*)v;
     WorkerResult* r = new WorkerResult;
     r->usersProcessed = 0;
     r->messagesProcessed = 0;
+    r->shardCount = 0;
+    r->shardLatency = nullptr;
+    r->channelLatency = nullptr;
+    r->firstChannel = 0;
+    r->channelCount = 0;
 
     for (int i = a->startIndex; i < a->endIndex; i++) {
         r->usersProcessed++;
         r->messagesProcessed += a->msgsPerUser;
     }
+
+    // the latency model runs on the shards dealt to this thread, which need
+    // not be the users counted above
+    int lo = -1;
+    int hi = -1;
+    for (int sh = a->firstShard; sh < CORE_SHARDS; sh += a->shardStride) {
+        r->shardCount++;
+        if (a->shardStart[sh + 1] <= a->shardStart[sh]) continue;
+        if (lo < 0 || a->shardStart[sh] < lo) lo = a->shardStart[sh];
+        if (a->shardStart[sh + 1] > hi) hi = a->shardStart[sh + 1];
+    }
+    if (r->shardCount == 0) return (void*)r;
+    r->shardLatency = new LatencyHistogram[r->shardCount];
+    if (lo < 0 || a->perChanCap <= 0) return (void*)r;
+
+    int chFirst = lo / a->perChanCap;
+    int chLast = (hi - 1) / a->perChanCap;
+    r->firstChannel = chFirst;
+    r->channelCount = chLast - chFirst + 1;
+    r->channelLatency = new LatencyHistogram[r->channelCount];
+
+    for (int i = 0; i < r->shardCount; i++) {
+        int sh = a->firstShard + i * a->shardStride;
+        simulate_shard(a, a->shardStart[sh], a->shardStart[sh + 1],
+                       r->shardLatency[i], r->channelLatency, chFirst);
+    }
     return (void*)r;
 }
 
+static WorkerArg make_worker_proto(const CellTower& tower, const CellularCore& core,
+                                   const UserDevice* arr) {
+    WorkerArg a;
+    a.arr = arr;
+    a.startIndex = 0;
+    a.endIndex = 0;
+    a.msgsPerUser = core.messagesPerUser();
+    a.shardStart = nullptr;
+    a.firstShard = 0;
+    a.shardStride = 1;
+    a.perChanCap = tower.usersPerChanCapacity();
+    a.antennas = tower.antennasPerChannel();
+    a.slots = tower.slotsPerFrame();
+    a.slotUs = tower.slotTimeUs(MESSAGE_BITS);
+    a.serviceUs = core.serviceTimeUs(CORE_MSG_RATE);
+    return a;
+}
+
+// Splits users [0, totalUsers) evenly over `threads` pthreads for the user and
+// message counts, and separately over CORE_SHARDS core shards for the latency
+// model; shard sh is computed by thread sh % threads. The simulated latencies
+// only depend on CORE_SHARDS, never on the thread count. The caller frees the
+// result with free_worker_results().
+static WorkerResult* run_workers(const WorkerArg& proto, int totalUsers, int threads) {
+    if (threads <= 0) threads = 1;
+
+    int shardStart[CORE_SHARDS + 1];
+    int base = totalUsers / CORE_SHARDS;
+    int rem = totalUsers % CORE_SHARDS;
+    shardStart[0] = 0;
+    for (int sh = 0; sh < CORE_SHARDS; sh++)
+        shardStart[sh + 1] = shardStart[sh] + base + (sh < rem ? 1 : 0);
+
+    pthread_t* tarr = new pthread_t[threads];
+    WorkerArg* args = new WorkerArg[threads];
+    WorkerResult* res = new WorkerResult[threads];
+
+    int userBase = totalUsers / threads;
+    int userRem = totalUsers % threads;
+
+    int start = 0;
+    int created = 0;
+    for (int t = 0; t < threads; t++) {
+        int chunk = userBase + (t < userRem ? 1 : 0);
+        args[t] = proto;
+        args[t].startIndex = start;
+        args[t].endIndex = start + chunk;
+        args[t].shardStart = shardStart;
+        args[t].firstShard = t;
+        args[t].shardStride = threads;
+
+        if (pthread_create(&tarr[t], NULL, worker_func, &args[t]) != 0) break;
+        created++;
+        start += chunk;
+    }
+
+    for (int t = 0; t < created; t++) {
+        void* p;
+        pthread_join(tarr[t], &p);
+        WorkerResult* wr = (WorkerResult*)p;
+        res[t] = *wr;
+        delete wr;
+    }
+
+    delete[] tarr;
+    delete[] args;
+    if (created != threads) {
+        for (int t = 0; t < created; t++) {
+            delete[] res[t].shardLatency;
+            delete[] res[t].channelLatency;
+        }
+        delete[] res;
+        throw ThreadException("Failed to create thread");
+    }
+    return res;
+}
+
+static void free_worker_results(WorkerResult* res, int threads) {
+    for (int t = 0; t < threads; t++) {
+        delete[] res[t].shardLatency;
+        delete[] res[t].channelLatency;
+    }
+    delete[] res;
+}
+
+static TrafficConfig make_traffic_config(const CellTower& tower, const CellularCore& core,
+                                         int towers, int usersPerTower, unsigned long long seed) {
+    TrafficConfig c;
+    c.towers = towers;
+    c.usersPerTower = usersPerTower;
+    c.msgsPerUser = core.messagesPerUser();
+    c.perChanCap = tower.usersPerChanCapacity();
+    c.antennas = tower.antennasPerChannel();
+    c.slots = tower.slotsPerFrame();
+    c.slotUs = tower.slotTimeUs(MESSAGE_BITS);
+    c.serviceUs = core.serviceTimeUs(CORE_MSG_RATE);
+    c.seed = seed;
+    c.crossPercent = CROSS_TOWER_PERCENT;
+    c.maxHops = MAX_HOPS;
+    c.hopLatencyUs = HOP_LATENCY_US;
+    c.coreQueueLimit = CORE_QUEUE_LIMIT;
+    return c;
+}
+
+static void print_network_run(const char* label, const NetworkStats& ns) {
+    io.outputstring(label);
+    io.outputstring(": delivered="); io.outputlong(ns.delivered);
+    io.outputstring(" dropped="); io.outputlong(ns.dropped);
+    io.outputstring(" cross_tower="); io.outputlong(ns.crossTower);
+    if (ns.windows > 0) {
+        io.outputstring(" windows="); io.outputlong(ns.windows);
+    }
+    io.outputstring(" wall="); io.outputlong(ns.wallUs / 1000);
+    io.outputstring(" ms\n");
+}
+
+static void print_latency_row(const char* label, int number, const CacheRow& r) {
+    io.outputstring(label);
+    if (number > 0) io.outputint(number);
+    io.outputstring(": n="); io.outputlong(r.latencyCount);
+    io.outputstring(" p50="); io.outputlong(r.p50);
+    io.outputstring(" p90="); io.outputlong(r.p90);
+    io.outputstring(" p99="); io.outputlong(r.p99);
+    io.outputstring(" p99.9="); io.outputlong(r.p999);
+    io.outputstring(" max="); io.outputlong(r.latencyMax);
+    io.outputstring(" us\n");
+}
+
+static void print_latency(const char* label, int number, const LatencyHistogram& h) {
+    CacheRow r = CacheRow();
+    cache_row_set_latency(r, h);
+    print_latency_row(label, number, r);
+}
+
+// value with two decimals, rounded half away from zero
+static void print_fixed2(double v) {
+    if (v < 0) {
+        io.outputstring("-");
+        v = -v;
+    }
+    long long scaled = (long long)(v * 100.0 + 0.5);
+    io.outputlong(scaled / 100);
+    io.outputstring(".");
+    if (scaled % 100 < 10) io.outputstring("0");
+    io.outputlong(scaled % 100);
+}
+
+// key fields shared by every cached row that depends on the timing model
+static void add_model_to_key(CacheKey& k) {
+    k.messageBits = MESSAGE_BITS;
+    k.coreMsgRate = CORE_MSG_RATE;
+    k.crossPercent = CROSS_TOWER_PERCENT;
+    k.maxHops = MAX_HOPS;
+    k.hopLatencyUs = HOP_LATENCY_US;
+    k.coreQueueLimit = CORE_QUEUE_LIMIT;
+}
+
 // ==================== MAIN =====================
 int main() {
     try {
 
+        ResultCache cache;
+        cache.open(RESULT_CACHE_PATH);
+
         io.outputstring("Cellular Network Simulator\n");
         io.outputstring("Project PDF: /mnt/data/OOPD____Project____2025.pdf\n");
 
@@ -87,6 +345,7 @@ int main() {
             if (requested <= 0)
                 io.errorstring("Enter positive integer:\n");
         }
+        int requestedInput = requested;
 
         // Template usage (does not change functionality)
         debugPrint("DEBUG: Users requested = ", requested);
@@ -132,7 +391,8 @@ int main() {
         // Thread count using sysconf()
         // ============================================================
         long sc = sysconf(_SC_NPROCESSORS_ONLN);
-        int threads = (sc > 0) ? (int)sc : 4;
+        int hwThreads = (sc > 0) ? (int)sc : 4;
+        int threads = hwThreads;
         if (threads > totalUsers) threads = totalUsers;
         if (threads <= 0) threads = 1;
 
@@ -194,40 +454,12 @@ int main() {
         io.outputstring("--- Threading Comparison (real pthreads) ---\n");
         io.outputstring("Threads used: "); io.outputint(threads); io.outputstring("\n");
 
-        pthread_t* tarr = new pthread_t[threads];
-        WorkerArg* args = new WorkerArg[threads];
-        WorkerResult* res = new WorkerResult[threads];
-
-        int base = totalUsers / threads;
-        int rem = totalUsers % threads;
-
-        int start = 0;
-        for (int t = 0; t < threads; t++) {
-            int chunk = base + (t < rem ? 1 : 0);
-            args[t].arr = arr;
-            args[t].startIndex = start;
-            args[t].endIndex = start + chunk;
-            args[t].msgsPerUser = msgsPerUser;
-
-            if (pthread_create(&tarr[t], NULL, worker_func, &args[t]) != 0) {
-                throw ThreadException("Failed to create thread");
-            }
-
-            start += chunk;
-        }
+        WorkerResult* res = run_workers(make_worker_proto(tower, core, arr), totalUsers, threads);
 
         long long maxMsgs = 0;
-
         for (int t = 0; t < threads; t++) {
-            void* p;
-            pthread_join(tarr[t], &p);
-            WorkerResult* wr = (WorkerResult*)p;
-
-            res[t] = *wr;
-            if (wr->messagesProcessed > maxMsgs)
-                maxMsgs = wr->messagesProcessed;
-
-            delete wr;
+            if (res[t].messagesProcessed > maxMsgs)
+                maxMsgs = res[t].messagesProcessed;
         }
 
         long long timeNonThread_ms = simulated_time_ms_nonthread(totalMessages);
@@ -256,9 +488,27 @@ int main() {
             io.outputstring("\n");
         }
 
-        delete[] tarr;
-        delete[] args;
-        delete[] res;
+        // ============================================================
+        // ========== PER-MESSAGE LATENCY =============================
+        // ============================================================
+        io.outputstring("--- Message Latency (tower arrival -> core completion) ---\n");
+        LatencyHistogram overall;
+        LatencyHistogram* chanLatency = new LatencyHistogram[channels > 0 ? channels : 1];
+        for (int t = 0; t < threads; t++) {
+            for (int sh = 0; sh < res[t].shardCount; sh++)
+                overall.merge(res[t].shardLatency[sh]);
+            for (int c = 0; c < res[t].channelCount; c++)
+                chanLatency[res[t].firstChannel + c].merge(res[t].channelLatency[c]);
+        }
+
+        print_latency("All messages", 0, overall);
+        for (int ch = 0; ch < printed; ch++)
+            print_latency(" Channel ", ch + 1, chanLatency[ch]);
+        for (int sh = 0; sh < CORE_SHARDS; sh++)
+            print_latency(" Core shard ", sh + 1, res[sh % threads].shardLatency[sh / threads]);
+
+        delete[] chanLatency;
+        free_worker_results(res, threads);
 
         // SPEED
         io.outputstring("Speed of selected technology: ");
@@ -272,6 +522,7 @@ int main() {
 
         // COMPARISON ALL STANDARDS
         io.outputstring("--- Comparison across all standards ---\n");
+        long long usersPerStandard[4];
         for (int i = 0; i < 4; i++) {
             CommunicationStandard* s = stds[i];
             long long chn = s->totalBandwidthKHz() / s->channelBandwidthKHz();
@@ -281,19 +532,204 @@ int main() {
             long long d2 = (long long)s->messagesPerUser() * (100 + s->overheadPer100Messages());
             long long ccap = (d2 > 0) ? (coreMsgCap * 100LL) / d2 : 0;
 
+            // latency of the same request on this standard, capped to its capacity
+            long long cmpUsers = requestedInput;
+            if (cmpUsers > bcap) cmpUsers = bcap;
+            if (cmpUsers > ccap) cmpUsers = ccap;
+            if (cmpUsers < 0) cmpUsers = 0;
+            usersPerStandard[i] = cmpUsers;
+            int cmpThreads = hwThreads < cmpUsers ? hwThreads : (int)cmpUsers;
+
+            CacheKey key = make_cache_key(CACHE_ROW_STANDARD, s);
+            key.users = cmpUsers;
+            key.coreMsgCap = coreMsgCap;
+            key.shards = CORE_SHARDS;
+            add_model_to_key(key);
+
+            CacheRow row;
+            if (!cache.lookup(key, row)) {
+                row = CacheRow();
+                row.channels = chn;
+                row.bandwidthCap = bcap;
+                row.coreCap = ccap;
+                row.users = cmpUsers;
+
+                if (cmpUsers > 0) {
+                    CellTower cmpTower(s);
+                    CellularCore cmpCore(s);
+                    cmpTower.reserve((int)cmpUsers);
+                    for (int u = 0; u < cmpUsers; u++)
+                        cmpTower.addUser(UserDevice(u + 1));
+
+                    WorkerResult* cmpRes = run_workers(
+                        make_worker_proto(cmpTower, cmpCore, cmpTower.userArray()),
+                        (int)cmpUsers, cmpThreads);
+
+                    LatencyHistogram cmpLatency;
+                    for (int t = 0; t < cmpThreads; t++)
+                        for (int sh = 0; sh < cmpRes[t].shardCount; sh++)
+                            cmpLatency.merge(cmpRes[t].shardLatency[sh]);
+                    free_worker_results(cmpRes, cmpThreads);
+                    cache_row_set_latency(row, cmpLatency);
+                }
+                cache.store(key, row);
+            }
+
             io.outputstring("Standard ");
             io.outputint(i + 1);
             io.outputstring(": channels=");
-            io.outputint((int)chn);
+            io.outputint((int)row.channels);
             io.outputstring(", bandwidth_cap=");
-            io.outputint((int)bcap);
+            io.outputint((int)row.bandwidthCap);
             io.outputstring(", core_cap=");
-            io.outputint((int)ccap);
+            io.outputint((int)row.coreCap);
             io.outputstring(", speed=");
             io.outputint(s->speedMbpsTimes10() / 10);
             io.outputstring(".");
             io.outputint(s->speedMbpsTimes10() % 10);
             io.outputstring(" Mbps\n");
+
+            if (row.latencyCount > 0)
+                print_latency_row("  latency", 0, row);
+        }
+
+        // ============================================================
+        // ========== MULTI-TOWER RUN (parallel DES) ==================
+        // ============================================================
+        io.outputstring("--- Multi-tower run ---\n");
+        io.outputstring("Enter number of towers (0 to skip):\n");
+        int towerCount = io.inputint();
+
+        CacheKey netKey = make_cache_key(CACHE_ROW_NETWORK, st);
+        netKey.users = totalUsers;
+        netKey.towers = towerCount;
+        netKey.seed = 1;
+        add_model_to_key(netKey);
+        CacheRow netRow;
+
+        if (towerCount > 0 && cache.lookup(netKey, netRow)) {
+            io.outputstring("Cached result for ");
+            io.outputint(towerCount);
+            io.outputstring(" towers: delivered="); io.outputlong(netRow.delivered);
+            io.outputstring(" dropped="); io.outputlong(netRow.dropped);
+            io.outputstring(" cross_tower="); io.outputlong(netRow.crossTower);
+            io.outputstring("\n");
+            print_latency_row("Network latency", 0, netRow);
+        } else if (towerCount > 0) {
+            TowerNetwork net(make_traffic_config(tower, core, towerCount, totalUsers, 1ULL));
+            int lpWorkers = hwThreads < towerCount ? hwThreads : towerCount;
+
+            io.outputstring("Towers: "); io.outputint(towerCount);
+            io.outputstring(", users per tower: "); io.outputint(totalUsers);
+            io.outputstring(", workers: "); io.outputint(lpWorkers);
+            io.outputstring(", lookahead: "); io.outputlong(net.lookaheadUs());
+            io.outputstring(" us\n");
+
+            // the global-queue run is only a correctness reference; speedup is
+            // measured against the same windowed engine on one worker
+            NetworkStats seqStats;
+            NetworkStats oneStats;
+            NetworkStats parStats;
+            net.runSequential(seqStats);
+            net.runParallel(1, oneStats);
+            net.runParallel(lpWorkers, parStats);
+
+            print_network_run("Sequential (global queue)", seqStats);
+            print_network_run("Parallel, workers=1", oneStats);
+            io.outputstring("Parallel, workers="); io.outputint(parStats.workers);
+            print_network_run("", parStats);
+            io.outputstring("Parallel matches sequential: ");
+            io.outputstring(seqStats.digest == parStats.digest && seqStats.digest == oneStats.digest
+                            ? "yes\n" : "NO\n");
+
+            long long pw = parStats.wallUs > 0 ? parStats.wallUs : 1;
+            long long sp100 = oneStats.wallUs * 100 / pw;
+            io.outputstring("Speedup vs 1 worker: ");
+            io.outputlong(sp100 / 100); io.outputstring(".");
+            if (sp100 % 100 < 10) io.outputstring("0");
+            io.outputlong(sp100 % 100); io.outputstring("x\n");
+
+            print_latency("Network latency", 0, parStats.latency);
+
+            netRow = CacheRow();
+            netRow.users = totalUsers;
+            cache_row_set_network(netRow, parStats);
+            cache.store(netKey, netRow);
+        }
+
+        // ============================================================
+        // ========== MONTE CARLO REPLICATION =========================
+        // ============================================================
+        io.outputstring("--- Monte Carlo replication ---\n");
+        io.outputstring("Enter target 95% CI half-width in tenths of a % of the mean\n");
+        io.outputstring("(e.g. 50 = 5%, 5 = 0.5%; 0 to skip):\n");
+        int ciPermille = io.inputint();
+
+        if (ciPermille > 0) {
+            int repTowers = towerCount > 0 ? towerCount : 1;
+            ReplicationPolicy policy;
+            policy.minReplicas = REPLICAS_MIN;
+            policy.maxReplicas = REPLICAS_MAX;
+            policy.targetRelHalfWidth = ciPermille / 1000.0;
+            policy.workers = hwThreads;
+
+            io.outputstring("Towers per replica: "); io.outputint(repTowers);
+            io.outputstring(", replicas: "); io.outputint(REPLICAS_MIN);
+            io.outputstring("-"); io.outputint(REPLICAS_MAX);
+            io.outputstring("\n");
+
+            for (int i = 0; i < 4; i++) {
+                if (usersPerStandard[i] <= 0) continue;
+                CommunicationStandard* s = stds[i];
+                CellTower repTower(s);
+                CellularCore repCore(s);
+
+                CacheKey repKey = make_cache_key(CACHE_ROW_NETWORK, s);
+                repKey.users = usersPerStandard[i];
+                repKey.towers = repTowers;
+                add_model_to_key(repKey);
+
+                ReplicationResult rr;
+                run_replications(
+                    make_traffic_config(repTower, repCore, repTowers, (int)usersPerStandard[i], 1ULL),
+                    repKey, cache, policy, rr);
+
+                io.outputstring("Standard ");
+                io.outputint(i + 1);
+                io.outputstring(": replicas="); io.outputint(rr.replicas);
+                io.outputstring(" simulated="); io.outputint(rr.simulated);
+                io.outputstring(rr.converged ? " (target reached)\n" : " (max replicas, target not reached)\n");
+
+                for (int m = 0; m < METRIC_COUNT; m++) {
+                    double mean = rr.metric[m].mean();
+                    double hw = replica_half_width(rr, m);
+                    io.outputstring("  ");
+                    io.outputstring(replica_metric_name(m));
+                    io.outputstring(": ");
+                    print_fixed2(mean);
+                    io.outputstring(" +/- ");
+                    print_fixed2(hw);
+                    if (mean != 0.0) {
+                        io.outputstring(" (");
+                        print_fixed2(hw * 100.0 / (mean < 0 ? -mean : mean));
+                        io.outputstring("%)");
+                    }
+                    io.outputstring("\n");
+                }
+            }
+        }
+
+        io.outputstring("Result cache: ");
+        if (cache.isOpen()) {
+            io.outputstring("hits="); io.outputlong(cache.hitCount());
+            io.outputstring(" misses="); io.outputlong(cache.missCount());
+            io.outputstring(" (" RESULT_CACHE_PATH);
+            if (cache.isFull()) io.outputstring(", cache full: new points are not stored");
+            io.outputstring(")\n");
+        } else {
+            io.outputstring("unavailable (" RESULT_CACHE_PATH ": ");
+            io.outputstring(cache.failureReason());
+            io.outputstring(")\n");
         }
 
         delete stds[0]; delete stds[1]; delete stds[2]; delete stds[3];